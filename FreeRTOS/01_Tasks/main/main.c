@@ -3,6 +3,7 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_log.h"
+#include "static_alloc.h"
 
 // Log tag for debug output
 static const char *TAG = "MACHINE_SYSTEM";
@@ -12,6 +13,11 @@ static const char *press_machine_name    = "PRESS_MACHINE";
 static const char *welding_machine_name  = "WELDING_MACHINE";
 static const char *painting_machine_name = "PAINTING_MACHINE";
 
+// Task Memory
+STATIC_TASK_DECLARE(press,    2048);
+STATIC_TASK_DECLARE(welding,  2048);
+STATIC_TASK_DECLARE(painting, 2048);
+
 /**
  * @brief Generic task function to simulate machine operation.
  * * @param pvParameters Pointer to the machine name string.
@@ -36,22 +42,22 @@ void app_main(void)
     ESP_LOGI(TAG, "System Initializing...");
     
     // 1. Create Press Machine Task
-    BaseType_t ret_press = xTaskCreate(machine_task, "Task_Press", 2048, (void*)press_machine_name, 5, NULL);
-    if (ret_press == pdPASS)
+    TaskHandle_t ret_press = STATIC_TASK_CREATE(press, machine_task, "Task_Press", (void*)press_machine_name, 5);
+    if (ret_press != NULL)
     {
         ESP_LOGI(TAG, "Press Machine Task started successfully.");
     }
 
     // 2. Create Welding Machine Task
-    BaseType_t ret_weld = xTaskCreate(machine_task, "Task_Welding", 2048, (void*)welding_machine_name, 5, NULL);
-    if (ret_weld == pdPASS)
+    TaskHandle_t ret_weld = STATIC_TASK_CREATE(welding, machine_task, "Task_Welding", (void*)welding_machine_name, 5);
+    if (ret_weld != NULL)
     {
         ESP_LOGI(TAG, "Welding Machine Task started successfully.");
     }
 
     // 3. Create Painting Machine Task
-    BaseType_t ret_paint = xTaskCreate(machine_task, "Task_Painting", 2048, (void*)painting_machine_name, 5, NULL);
-    if (ret_paint == pdPASS)
+    TaskHandle_t ret_paint = STATIC_TASK_CREATE(painting, machine_task, "Task_Painting", (void*)painting_machine_name, 5);
+    if (ret_paint != NULL)
     {
         ESP_LOGI(TAG, "Painting Machine Task started successfully.");
     }
@@ -4,6 +4,11 @@
 #include "freertos/task.h"
 #include "freertos/queue.h"
 #include "esp_log.h"
+#include "static_alloc.h"
+
+#if CONFIG_TRACE_RECORDER_ENABLE
+#include "trace_recorder.h"
+#endif
 
 static const char *TAG = "GPS_SYSTEM";
 
@@ -17,6 +22,10 @@ typedef struct {
 #define QUEUE_LENGTH    10
 #define ITEM_SIZE       sizeof(gps_data_t)
 
+// Kernel Objects
+STATIC_QUEUE_DECLARE(gps_queue, QUEUE_LENGTH, ITEM_SIZE);
+STATIC_TASK_DECLARE(gps_producer, 2048);
+STATIC_TASK_DECLARE(display_consumer, 2048);
 
 QueueHandle_t gps_queue;
 
@@ -65,12 +74,20 @@ void app_main(void)
 {
     ESP_LOGI(TAG, "System Initializing...");
 
-    gps_queue = xQueueCreate(QUEUE_LENGTH, ITEM_SIZE);
+    gps_queue = STATIC_QUEUE_CREATE(gps_queue);
     if (gps_queue == NULL) {
         ESP_LOGE(TAG, "Failed to create Queue!");
         return;
     }
 
-    xTaskCreate(gps_producer_task, "GPS_Producer", 2048, NULL, 5, NULL);
-    xTaskCreate(display_consumer_task, "Display_Consumer", 2048, NULL, 5, NULL);
+#if CONFIG_TRACE_RECORDER_ENABLE
+    // Kernel trace: one event per second would take minutes to fill a snapshot,
+    // so the new records are streamed as TRACE: lines every flush period
+    trace_recorder_name_queue(gps_queue, "GPS_Queue");
+    trace_recorder_measure_overhead();
+    trace_recorder_start(TRACE_MODE_STREAM);
+#endif
+
+    STATIC_TASK_CREATE(gps_producer, gps_producer_task, "GPS_Producer", NULL, 5);
+    STATIC_TASK_CREATE(display_consumer, display_consumer_task, "Display_Consumer", NULL, 5);
 }
\ No newline at end of file
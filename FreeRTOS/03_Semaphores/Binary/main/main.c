@@ -3,10 +3,16 @@
 #include "freertos/task.h"
 #include "freertos/semphr.h"
 #include "esp_log.h"
+#include "static_alloc.h"
 
 static const char *TAG = "WORKFLOW";
 SemaphoreHandle_t work_signal_sem;
 
+// Kernel Objects
+STATIC_SEMAPHORE_DECLARE(work_signal);
+STATIC_TASK_DECLARE(manager, 2048);
+STATIC_TASK_DECLARE(employee, 2048);
+
 void manager_task(void *pvParameters)
 {
     for (;;) {
@@ -29,7 +35,7 @@ void employee_task(void *pvParameters)
 
 void app_main(void)
 {
-    work_signal_sem = xSemaphoreCreateBinary();
-    xTaskCreate(manager_task, "Manager", 2048, NULL, 5, NULL);
-    xTaskCreate(employee_task, "Employee", 2048, NULL, 5, NULL);
+    work_signal_sem = STATIC_BINARY_SEMAPHORE_CREATE(work_signal);
+    STATIC_TASK_CREATE(manager, manager_task, "Manager", NULL, 5);
+    STATIC_TASK_CREATE(employee, employee_task, "Employee", NULL, 5);
 }
\ No newline at end of file
@@ -3,11 +3,20 @@
 #include "freertos/task.h"
 #include "freertos/semphr.h"
 #include "esp_log.h"
+#include "static_alloc.h"
 
 static const char *TAG = "PARKING_LOT";
 SemaphoreHandle_t parking_sem;
 #define MAX_SPOTS 3
 
+// Kernel Objects
+STATIC_SEMAPHORE_DECLARE(parking);
+STATIC_TASK_DECLARE(car1, 2048);
+STATIC_TASK_DECLARE(car2, 2048);
+STATIC_TASK_DECLARE(car3, 2048);
+STATIC_TASK_DECLARE(car4, 2048);
+STATIC_TASK_DECLARE(car5, 2048);
+
 void car_task(void *pvParameters)
 {
     char *car_name = (char *)pvParameters;
@@ -26,12 +35,12 @@ void car_task(void *pvParameters)
 void app_main(void)
 {
     ESP_LOGI(TAG, "Opening Parking Lot...");
-    parking_sem = xSemaphoreCreateCounting(MAX_SPOTS, MAX_SPOTS);
+    parking_sem = STATIC_COUNTING_SEMAPHORE_CREATE(parking, MAX_SPOTS, MAX_SPOTS);
     if(parking_sem != NULL) {
-        xTaskCreate(car_task, "Car1", 2048, (void*)"Car_1", 5, NULL);
-        xTaskCreate(car_task, "Car2", 2048, (void*)"Car_2", 5, NULL);
-        xTaskCreate(car_task, "Car3", 2048, (void*)"Car_3", 5, NULL);
-        xTaskCreate(car_task, "Car4", 2048, (void*)"Car_4", 5, NULL);
-        xTaskCreate(car_task, "Car5", 2048, (void*)"Car_5", 5, NULL);
+        STATIC_TASK_CREATE(car1, car_task, "Car1", (void*)"Car_1", 5);
+        STATIC_TASK_CREATE(car2, car_task, "Car2", (void*)"Car_2", 5);
+        STATIC_TASK_CREATE(car3, car_task, "Car3", (void*)"Car_3", 5);
+        STATIC_TASK_CREATE(car4, car_task, "Car4", (void*)"Car_4", 5);
+        STATIC_TASK_CREATE(car5, car_task, "Car5", (void*)"Car_5", 5);
     }
 }
\ No newline at end of file
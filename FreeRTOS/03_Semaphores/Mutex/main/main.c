@@ -4,10 +4,16 @@
 #include "freertos/task.h"
 #include "freertos/semphr.h"
 #include "esp_log.h"
+#include "static_alloc.h"
 
 static const char *TAG = "PRINTER_SYSTEM";
 SemaphoreHandle_t mutex_printer;
 
+// Kernel Objects
+STATIC_SEMAPHORE_DECLARE(printer);
+STATIC_TASK_DECLARE(doc_a, 2048);
+STATIC_TASK_DECLARE(doc_b, 2048);
+
 void printer_write(const char *message)
 {
     if (xSemaphoreTake(mutex_printer, portMAX_DELAY) == pdTRUE)
@@ -36,7 +42,7 @@ void task_doc_b(void *pvParameters)
 
 void app_main(void)
 {
-    mutex_printer = xSemaphoreCreateMutex();
-    xTaskCreate(task_doc_a, "TaskA", 2048, NULL, 5, NULL);
-    xTaskCreate(task_doc_b, "TaskB", 2048, NULL, 5, NULL);
+    mutex_printer = STATIC_MUTEX_CREATE(printer);
+    STATIC_TASK_CREATE(doc_a, task_doc_a, "TaskA", NULL, 5);
+    STATIC_TASK_CREATE(doc_b, task_doc_b, "TaskB", NULL, 5);
 }
\ No newline at end of file
@@ -3,9 +3,22 @@
 #include "freertos/task.h"
 #include "freertos/event_groups.h"
 #include "esp_log.h"
+#include "static_alloc.h"
+#include "alloc_stats.h"
 
 static const char *TAG = "ROCKET_LAUNCH";
 
+/* Stack sizes (in bytes on ESP-IDF) */
+#define CONTROL_STACK_SIZE      4096
+#define TEAM_STACK_SIZE         2048
+
+/* Kernel Objects */
+STATIC_TASK_DECLARE(launch_control, CONTROL_STACK_SIZE);
+STATIC_TASK_DECLARE(fuel_check,     TEAM_STACK_SIZE);
+STATIC_TASK_DECLARE(weather_check,  TEAM_STACK_SIZE);
+STATIC_TASK_DECLARE(system_check,   TEAM_STACK_SIZE);
+STATIC_EVENT_GROUP_DECLARE(rocket_event_group);
+
 /* Event Group Handle */
 EventGroupHandle_t rocket_event_group;
 
@@ -75,11 +88,24 @@ void system_check_task(void *pvParameters)
 
 void app_main(void)
 {
+    alloc_stats_begin();
     ESP_LOGI(TAG, "--- MISSION START ---");
-    rocket_event_group = xEventGroupCreate();
 
-    xTaskCreate(launch_control_task, "Launch_Control", 4096, NULL, 5, NULL);
-    xTaskCreate(fuel_check_task,     "Fuel_Team",      2048, NULL, 5, NULL);
-    xTaskCreate(weather_check_task,  "Weather_Team",   2048, NULL, 5, NULL);
-    xTaskCreate(system_check_task,   "Systems_Eng",    2048, NULL, 5, NULL);
+    rocket_event_group = STATIC_EVENT_GROUP_CREATE(rocket_event_group);
+    if (rocket_event_group == NULL)
+    {
+        ESP_LOGE(TAG, "Event Group creation failed!");
+        return;
+    }
+
+    if (STATIC_TASK_CREATE(launch_control, launch_control_task, "Launch_Control", NULL, 5) == NULL ||
+        STATIC_TASK_CREATE(fuel_check,     fuel_check_task,     "Fuel_Team",      NULL, 5) == NULL ||
+        STATIC_TASK_CREATE(weather_check,  weather_check_task,  "Weather_Team",   NULL, 5) == NULL ||
+        STATIC_TASK_CREATE(system_check,   system_check_task,   "Systems_Eng",    NULL, 5) == NULL)
+    {
+        ESP_LOGE(TAG, "Task creation failed!");
+    }
+
+    /* Boot & Heap Report: compare a static and a dynamic build (see README.md) */
+    alloc_stats_report(TAG);
 }
\ No newline at end of file
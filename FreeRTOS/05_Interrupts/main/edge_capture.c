@@ -0,0 +1,165 @@
+#include <string.h>
+#include "esp_log.h"
+#include "edge_capture.h"
+
+#if CONFIG_IDF_TARGET_LINUX
+#include <time.h>
+#define EDGE_IRAM_ATTR
+#else
+#include "esp_attr.h"
+#include "esp_timer.h"
+#define EDGE_IRAM_ATTR          IRAM_ATTR
+#endif
+
+_Static_assert((EDGE_RING_SIZE & (EDGE_RING_SIZE - 1)) == 0, "EDGE_RING_SIZE must be a power of two");
+
+#define EDGE_INIT_TIMEOUT_MS    100
+
+static const char *TAG = "EDGE_CAPTURE";
+
+
+uint32_t EDGE_IRAM_ATTR edge_capture_time_us(void)
+{
+#if CONFIG_IDF_TARGET_LINUX
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL);
+#else
+    return (uint32_t)esp_timer_get_time();
+#endif
+}
+
+// -------------------------------------------------------------------------
+// Producer (ISR side)
+// Single producer: only the ISR writes head, so no lock is needed.
+// -------------------------------------------------------------------------
+void EDGE_IRAM_ATTR edge_capture_push(edge_capture_t *cap, uint32_t timestamp_us)
+{
+    uint32_t head = cap->head;
+    uint32_t tail = __atomic_load_n(&cap->tail, __ATOMIC_ACQUIRE);
+
+    if (head - tail >= EDGE_RING_SIZE)
+    {
+        cap->stats.ring_overflow++;
+        return;
+    }
+
+    cap->ring[head & (EDGE_RING_SIZE - 1)] = timestamp_us;
+    __atomic_store_n(&cap->head, head + 1, __ATOMIC_RELEASE);
+}
+
+void EDGE_IRAM_ATTR edge_capture_isr_handler(void *arg)
+{
+    //.. No kernel call here: the filter timer picks the edge up later
+    edge_capture_push((edge_capture_t *)arg, edge_capture_time_us());
+}
+
+// -------------------------------------------------------------------------
+// Consumer (filter timer, runs in the timer service task)
+// -------------------------------------------------------------------------
+static void edge_capture_send_batch(edge_capture_t *cap, edge_batch_t *batch)
+{
+    if (batch->count == 0)
+    {
+        return;
+    }
+
+    //.. Never block the timer service task
+    if (xQueueSend(cap->batch_queue, batch, 0) == pdTRUE)
+    {
+        cap->stats.accepted += batch->count;
+    }
+    else
+    {
+        cap->stats.batch_overflow += batch->count;
+    }
+    batch->count = 0;
+}
+
+void edge_capture_timer_cb(TimerHandle_t xTimer)
+{
+    edge_capture_t *cap = (edge_capture_t *)pvTimerGetTimerID(xTimer);
+    edge_batch_t batch = { .count = 0 };
+
+    uint32_t head = __atomic_load_n(&cap->head, __ATOMIC_ACQUIRE);
+    uint32_t tail = cap->tail;
+
+    while (tail != head)
+    {
+        uint32_t timestamp = cap->ring[tail & (EDGE_RING_SIZE - 1)];
+        tail++;
+
+        //.. Glitch/debounce filter: ignore edges too close to the last accepted one
+        if (cap->has_last && (uint32_t)(timestamp - cap->last_accepted_us) < cap->glitch_us)
+        {
+            cap->stats.filtered++;
+            continue;
+        }
+        cap->last_accepted_us = timestamp;
+        cap->has_last = true;
+
+        batch.timestamps_us[batch.count++] = timestamp;
+        if (batch.count == EDGE_BATCH_MAX)
+        {
+            edge_capture_send_batch(cap, &batch);
+        }
+
+        //.. Give the slots back early, so a long burst does not overflow the ring
+        __atomic_store_n(&cap->tail, tail, __ATOMIC_RELEASE);
+    }
+
+    __atomic_store_n(&cap->tail, tail, __ATOMIC_RELEASE);
+    edge_capture_send_batch(cap, &batch);
+}
+
+// -------------------------------------------------------------------------
+// Public API
+// -------------------------------------------------------------------------
+esp_err_t edge_capture_init(edge_capture_t *cap, QueueHandle_t batch_queue, TimerHandle_t filter_timer,
+                            uint32_t glitch_us)
+{
+    memset(cap, 0, sizeof(*cap));
+    cap->glitch_us = glitch_us;
+
+    if (batch_queue == NULL)
+    {
+        ESP_LOGE(TAG, "Batch queue creation failed!");
+        if (filter_timer != NULL && xTimerDelete(filter_timer, pdMS_TO_TICKS(EDGE_INIT_TIMEOUT_MS)) != pdPASS)
+        {
+            ESP_LOGE(TAG, "Filter timer delete failed, timer leaked!");
+        }
+        return ESP_ERR_NO_MEM;
+    }
+
+    if (filter_timer == NULL)
+    {
+        ESP_LOGE(TAG, "Filter timer creation failed!");
+        vQueueDelete(batch_queue);
+        return ESP_ERR_NO_MEM;
+    }
+
+    cap->batch_queue = batch_queue;
+    cap->filter_timer = filter_timer;
+
+    //.. Start goes through the timer command queue, it fails if that queue is full
+    if (xTimerStart(cap->filter_timer, 0) != pdPASS)
+    {
+        ESP_LOGE(TAG, "Filter timer start failed (timer command queue full)!");
+        //.. Delete uses the same command queue, give the timer task time to empty it
+        if (xTimerDelete(cap->filter_timer, pdMS_TO_TICKS(EDGE_INIT_TIMEOUT_MS)) != pdPASS)
+        {
+            ESP_LOGE(TAG, "Filter timer delete failed, timer leaked!");
+        }
+        vQueueDelete(cap->batch_queue);
+        cap->filter_timer = NULL;
+        cap->batch_queue = NULL;
+        return ESP_FAIL;
+    }
+
+    return ESP_OK;
+}
+
+bool edge_capture_receive(edge_capture_t *cap, edge_batch_t *batch, TickType_t wait)
+{
+    return xQueueReceive(cap->batch_queue, batch, wait) == pdTRUE;
+}
@@ -0,0 +1,105 @@
+/**
+ * @file edge_capture.h
+ * @brief Burst-safe GPIO edge capture with timer based glitch filter
+ *
+ * The ISR only stores a timestamp into a lock-free ring buffer, so no edge
+ * is merged or lost while a task is busy. A FreeRTOS software timer drains
+ * the ring every EDGE_BATCH_PERIOD_MS, drops glitches (edges closer than
+ * glitch_us to the last accepted edge) and sends the accepted edges to the
+ * consumer in batches.
+ *
+ * Typical use: pulse counting from encoders, flow meters or buttons.
+ * */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/timers.h"
+#include "static_alloc.h"
+
+// --- CONFIGURATION ---
+#define EDGE_RING_SIZE          256     // Edges buffered between two timer runs (power of two)
+#define EDGE_BATCH_MAX          32      // Edges per batch delivered to the consumer
+#define EDGE_BATCH_QUEUE_LEN    16      // Batches waiting for the consumer
+#define EDGE_BATCH_PERIOD_MS    10      // Filter timer period
+
+// --- DATA STRUCTURES ---
+typedef struct {
+    uint32_t count;
+    uint32_t timestamps_us[EDGE_BATCH_MAX];
+} edge_batch_t;
+
+typedef struct {
+    uint32_t accepted;          // Edges delivered to the consumer
+    uint32_t filtered;          // Edges rejected by the glitch filter
+    uint32_t ring_overflow;     // Edges lost in the ISR because the ring was full
+    uint32_t batch_overflow;    // Edges lost because the consumer was too slow
+} edge_capture_stats_t;
+
+typedef struct {
+    //.. Written by the ISR (head) and the filter timer (tail) only
+    uint32_t ring[EDGE_RING_SIZE];
+    uint32_t head;
+    uint32_t tail;
+
+    uint32_t glitch_us;
+    uint32_t last_accepted_us;
+    bool     has_last;
+
+    edge_capture_stats_t stats;
+    QueueHandle_t batch_queue;
+    TimerHandle_t filter_timer;
+} edge_capture_t;
+
+// --- DECLARATION ---
+//.. The batch queue and the filter timer go through static_alloc.h (heap or .bss)
+#define EDGE_CAPTURE_DECLARE(name) \
+    STATIC_QUEUE_DECLARE(name##_batches, EDGE_BATCH_QUEUE_LEN, sizeof(edge_batch_t)); \
+    STATIC_TIMER_DECLARE(name##_filter); \
+    static edge_capture_t name
+
+#define EDGE_CAPTURE_INIT(name, label, glitch_us) \
+    edge_capture_init(&(name), STATIC_QUEUE_CREATE(name##_batches), \
+                      STATIC_TIMER_CREATE(name##_filter, (label), pdMS_TO_TICKS(EDGE_BATCH_PERIOD_MS), \
+                                          pdTRUE, &(name), edge_capture_timer_cb), \
+                      (glitch_us))
+
+/**
+ * @brief Take over the batch queue and the filter timer, and start the timer.
+ * Use EDGE_CAPTURE_INIT(), it creates both objects. If one of them is NULL
+ * (creation failed) the other one is deleted.
+ *
+ * @param glitch_us Minimum time between two accepted edges (debounce), 0 disables the filter
+ */
+esp_err_t edge_capture_init(edge_capture_t *cap, QueueHandle_t batch_queue, TimerHandle_t filter_timer,
+                            uint32_t glitch_us);
+
+/**
+ * @brief Filter timer callback (drains the ring), the timer ID is the edge_capture_t.
+ */
+void edge_capture_timer_cb(TimerHandle_t xTimer);
+
+/**
+ * @brief GPIO ISR handler, register it with gpio_isr_handler_add(pin, edge_capture_isr_handler, cap).
+ */
+void edge_capture_isr_handler(void *arg);
+
+/**
+ * @brief Store one edge with the given timestamp. ISR safe, never blocks.
+ * Used by the ISR handler, and by simulators that generate their own timestamps.
+ */
+void edge_capture_push(edge_capture_t *cap, uint32_t timestamp_us);
+
+/**
+ * @brief Wait for the next batch of accepted edges.
+ */
+bool edge_capture_receive(edge_capture_t *cap, edge_batch_t *batch, TickType_t wait);
+
+/**
+ * @brief Current timestamp used for the edges (microseconds, wraps every ~71 minutes).
+ */
+uint32_t edge_capture_time_us(void);
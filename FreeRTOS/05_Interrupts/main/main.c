@@ -1,77 +1,309 @@
 #include <stdio.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
-#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "static_alloc.h"
+#include "edge_capture.h"
+
+#if CONFIG_IDF_TARGET_LINUX
+// No GPIO on the linux target: a task simulates the button, a pthread stress tests the capture
+#include <pthread.h>
+#include <signal.h>
+#include <time.h>
+#else
 #include "driver/gpio.h"
+#endif
+
+#if CONFIG_TRACE_RECORDER_ENABLE
+#include "trace_recorder.h"
+#endif
 
 
 
 // Log tag for debug output
 static const char *TAG = "DEBUG";
 
+#if !CONFIG_IDF_TARGET_LINUX
 // BOOT button on ESP32-C6 DevKit (GPIO 9)
 #define BOOT_BUTTON_PIN GPIO_NUM_9
+#endif
+
+// Debounce: edges closer than this to the last accepted one are contact bounce.
+// For encoders and flow meters use the shortest real pulse period instead (e.g. 100us).
+#define DEBOUNCE_US     50000
 
-// Global Semaphore Handle (Bridge between ISR and Task)
-SemaphoreHandle_t xBinarySemaphore = NULL;
+// Capture Handle (Bridge between ISR and Task)
+// The ISR only stores a timestamp, so edges in bursts are never merged.
+EDGE_CAPTURE_DECLARE(button_capture);
+
+// Kernel Objects
+STATIC_TASK_DECLARE(button_handler, 3072);
 
 // -------------------------------------------------------------------------
-// ISR (Interrupt Service Routine) Function
-// NOTE: This must be placed in IRAM_ATTR to execute very fast.
-// Never use printf or vTaskDelay inside an ISR!
+// Button Handler Task (The Worker)
 // -------------------------------------------------------------------------
-static void IRAM_ATTR gpio_isr_handler(void* arg)
+void button_handler_task(void *pvParameters)
 {
-    // Variable to check if a context switch is needed
-    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    edge_batch_t batch;
+    uint32_t total_presses = 0;
 
-    // Give the "Wake Up" signal to the Task.
-    // CAUTION: We must use the "FromISR" version here!
-    xSemaphoreGiveFromISR(xBinarySemaphore, &xHigherPriorityTaskWoken);
+    while(1)
+    {
+        // Wait for a batch of debounced edges indefinitely (portMAX_DELAY)
+        // No vTaskDelay() here: debouncing is done by the filter timer.
+        if(edge_capture_receive(&button_capture, &batch, portMAX_DELAY))
+        {
+            ESP_LOGI(TAG, "----------------------------------------");
+            ESP_LOGI(TAG, "🔥 INTERRUPT DETECTED! %lu press(es) in this batch.", (unsigned long)batch.count);
 
-    // If the semaphore woke up a higher priority task, 
-    // force a context switch immediately upon exiting the ISR.
-    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+            for(uint32_t i = 0; i < batch.count; i++)
+            {
+                total_presses++;
+                ESP_LOGI(TAG, "   #%lu at %lu us", (unsigned long)total_presses, (unsigned long)batch.timestamps_us[i]);
+            }
+
+            ESP_LOGI(TAG, "   Filtered bounces: %lu | Lost: %lu",
+                     (unsigned long)button_capture.stats.filtered,
+                     (unsigned long)(button_capture.stats.ring_overflow + button_capture.stats.batch_overflow));
+            ESP_LOGI(TAG, "----------------------------------------");
+        }
+    }
 }
 
+#if CONFIG_IDF_TARGET_LINUX
 // -------------------------------------------------------------------------
-// Button Handler Task (The Worker)
+// Button Simulator (linux target only)
+// Calls the ISR function directly, every press bounces once (filtered).
+// This is the flow that the trace recorder captures.
 // -------------------------------------------------------------------------
-void button_handler_task(void *pvParameters)
+#define SIMULATED_PRESS_MS      300
+#define SIMULATED_PRESSES       10
+
+STATIC_TASK_DECLARE(button_simulator, 2048);
+
+void button_simulator_task(void *pvParameters)
+{
+    for(int i = 0; i < SIMULATED_PRESSES; i++)
+    {
+        vTaskDelay(pdMS_TO_TICKS(SIMULATED_PRESS_MS));
+        edge_capture_isr_handler(&button_capture);
+        edge_capture_isr_handler(&button_capture);  // Contact bounce
+    }
+
+    // Let the last batch reach the handler, then hand over to the stress test
+    vTaskDelay(pdMS_TO_TICKS(5 * EDGE_BATCH_PERIOD_MS));
+    if(pvParameters != NULL)
+    {
+        xTaskNotifyGive((TaskHandle_t)pvParameters);
+    }
+    vTaskDelete(NULL);
+}
+
+// -------------------------------------------------------------------------
+// Stress Test (linux target only)
+// A plain pthread stands in for the GPIO interrupt: it runs in parallel to
+// the FreeRTOS tasks and calls edge_capture_isr_handler() at a wall-clock
+// paced rate, so the edges carry real edge_capture_time_us() timestamps.
+// Every 8th edge bounces: it is pushed with its bounce 1us later (exact
+// timestamps, so a host preemption can not split the pair), the filter
+// must drop the bounce. A round passes only if every real edge is
+// delivered and exactly the bounces are filtered: a real edge dropped by
+// the filter is a missed pulse too. The rate is raised until the first
+// round that fails.
+// -------------------------------------------------------------------------
+#define STRESS_GLITCH_US    2       // Shorter than the fastest edge spacing (5us)
+#define STRESS_ROUND_MS     1000
+
+static const uint32_t stress_rates[] = { 1000, 2000, 5000, 10000, 20000, 50000, 100000, 200000 };
+
+EDGE_CAPTURE_DECLARE(stress_capture);
+STATIC_TASK_DECLARE(stress_consumer, 2048);
+STATIC_TASK_DECLARE(stress_test, 4096);
+static volatile uint32_t stress_received = 0;
+
+typedef struct {
+    uint32_t rate;
+    uint32_t sent;
+    uint32_t bounces;
+    uint32_t late;
+    volatile bool done;
+} stress_round_t;
+
+static inline uint64_t stress_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void *stress_edge_thread(void *arg)
+{
+    stress_round_t *round = (stress_round_t *)arg;
+
+    // Leave the FreeRTOS port signals (tick, yield) to the FreeRTOS threads
+    sigset_t all;
+    sigfillset(&all);
+    pthread_sigmask(SIG_BLOCK, &all, NULL);
+
+    uint64_t spacing_ns = 1000000000ULL / round->rate;
+    uint64_t start = stress_now_ns();
+    uint64_t next = start;
+    uint64_t end = start + (uint64_t)STRESS_ROUND_MS * 1000000ULL;
+
+    while(next < end)
+    {
+        // Spin until the next edge is due (sleep granularity is too coarse)
+        uint64_t now;
+        while((now = stress_now_ns()) < next) { }
+
+        // Descheduled by the host: resync instead of firing the next edge on the
+        // old schedule, it could land closer than the glitch filter and get dropped.
+        // Up to half a spacing late, the gap to the next edge stays above the filter.
+        if(now - next > spacing_ns / 2)
+        {
+            round->late++;
+            next = now;
+        }
+
+        if((round->sent & 7) == 0)
+        {
+            uint32_t timestamp = edge_capture_time_us();
+            edge_capture_push(&stress_capture, timestamp);
+            edge_capture_push(&stress_capture, timestamp + 1);
+            round->bounces++;
+        }
+        else
+        {
+            edge_capture_isr_handler(&stress_capture);
+        }
+        round->sent++;
+        next += spacing_ns;
+    }
+
+    round->done = true;
+    return NULL;
+}
+
+void stress_consumer_task(void *pvParameters)
 {
+    edge_batch_t batch;
+
     while(1)
     {
-        // Wait for the Semaphore indefinitely (portMAX_DELAY)
-        // The CPU sleeps here until the semaphore is given by the ISR.
-        if(xSemaphoreTake(xBinarySemaphore, portMAX_DELAY) == pdTRUE)
+        if(edge_capture_receive(&stress_capture, &batch, portMAX_DELAY))
+        {
+            stress_received += batch.count;
+        }
+    }
+}
+
+void stress_test_task(void *pvParameters)
+{
+    // Wait for the button simulation, it is the part that gets traced
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+#if CONFIG_TRACE_RECORDER_ENABLE
+    // The numbers below must not include the recorder overhead
+    trace_recorder_stop();
+    ESP_LOGI(TAG, "Trace recorder stopped for the stress test");
+#endif
+
+    if(EDGE_CAPTURE_INIT(stress_capture, "Stress_Filter", STRESS_GLITCH_US) != ESP_OK ||
+       STATIC_TASK_CREATE(stress_consumer, stress_consumer_task, "Stress_Consumer", NULL, 10) == NULL)
+    {
+        ESP_LOGE(TAG, "Failed to create stress test!");
+        vTaskDelete(NULL);
+    }
+
+    uint32_t max_rate = 0;
+    bool failed = false;
+
+    for(size_t r = 0; r < sizeof(stress_rates) / sizeof(stress_rates[0]) && !failed; r++)
+    {
+        stress_round_t round = { .rate = stress_rates[r] };
+        edge_capture_stats_t before = stress_capture.stats;
+        uint32_t received_before = stress_received;
+
+        pthread_t thread;
+        if(pthread_create(&thread, NULL, stress_edge_thread, &round) != 0)
+        {
+            ESP_LOGE(TAG, "Failed to start edge thread!");
+            break;
+        }
+        while(!round.done)
         {
-            // If we are here, the button was pressed and ISR signaled us.
-            ESP_LOGI("----------------------------------------\n");
-            ESP_LOGI("🔥 INTERRUPT DETECTED! Button Pressed.\n");
-            ESP_LOGI("   Heavy processing can be done here...\n");
-            ESP_LOGI("----------------------------------------\n");
-
-            // Simple software debounce delay
-            // In real projects, hardware debounce is preferred.
-            vTaskDelay(pdMS_TO_TICKS(50)); 
+            vTaskDelay(pdMS_TO_TICKS(10));
         }
+        pthread_join(thread, NULL);
+
+        // Let the filter timer and the consumer catch up
+        vTaskDelay(pdMS_TO_TICKS(5 * EDGE_BATCH_PERIOD_MS));
+
+        uint32_t received = stress_received - received_before;
+        uint32_t filtered = stress_capture.stats.filtered - before.filtered;
+        uint32_t ring_lost = stress_capture.stats.ring_overflow - before.ring_overflow;
+        uint32_t batch_lost = stress_capture.stats.batch_overflow - before.batch_overflow;
+
+        // Checked separately: lost real edges (overflow or wrongly filtered), and bounces let through
+        int32_t missed = (int32_t)(round.sent - received);
+        int32_t bounces_passed = (int32_t)(round.bounces - filtered);
+
+        ESP_LOGI(TAG, "%6lu edges/s: sent %lu (+%lu bounces, %lu late), received %lu, filtered %lu | missed %ld (ring %lu, batch %lu), bounces passed %ld",
+                 (unsigned long)round.rate, (unsigned long)round.sent, (unsigned long)round.bounces,
+                 (unsigned long)round.late, (unsigned long)received, (unsigned long)filtered,
+                 (long)missed, (unsigned long)ring_lost, (unsigned long)batch_lost, (long)bounces_passed);
+
+        if(received == round.sent && filtered == round.bounces)
+        {
+            max_rate = round.rate;
+        }
+        else
+        {
+            failed = true;
+        }
+    }
+
+    if(failed)
+    {
+        ESP_LOGI(TAG, "Max sustainable edge rate: %lu edges/s (ring %d, timer period %d ms)",
+                 (unsigned long)max_rate, EDGE_RING_SIZE, EDGE_BATCH_PERIOD_MS);
+    }
+    else
+    {
+        ESP_LOGI(TAG, "No edge lost up to %lu edges/s (highest tested rate)", (unsigned long)max_rate);
     }
+    vTaskDelete(NULL);
 }
+#endif
 
 // -------------------------------------------------------------------------
 // Main Application
 // -------------------------------------------------------------------------
 void app_main(void)
 {
-    // 1. Create Binary Semaphore
-    xBinarySemaphore = xSemaphoreCreateBinary();
-
-    if(xBinarySemaphore == NULL) {
-        ESP_LOGI("Failed to create semaphore!\n");
+    // 1. Create the Capture Path (Ring Buffer + Filter Timer + Batch Queue)
+    if(EDGE_CAPTURE_INIT(button_capture, "Edge_Filter", DEBOUNCE_US) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to create edge capture!");
         return;
     }
 
-    // 2. Button Configuration (GPIO Settings)
+#if CONFIG_TRACE_RECORDER_ENABLE
+    // Kernel trace: dumped as TRACE: lines when the buffer is full (or stopped)
+    trace_recorder_name_queue(button_capture.batch_queue, "Edge_Batches");
+    trace_recorder_measure_overhead();
+    trace_recorder_start(TRACE_MODE_SNAPSHOT);
+#endif
+
+    // 2. Create the Handler Task
+    // We give it high priority (10) to respond immediately.
+    STATIC_TASK_CREATE(button_handler, button_handler_task, "Button_Task", NULL, 10);
+
+#if CONFIG_IDF_TARGET_LINUX
+    TaskHandle_t stress_task = STATIC_TASK_CREATE(stress_test, stress_test_task, "Stress_Test", NULL, 5);
+    STATIC_TASK_CREATE(button_simulator, button_simulator_task, "Button_Sim", stress_task, 5);
+    ESP_LOGI(TAG, "System Ready! Simulating %d button presses, then running the stress test...", SIMULATED_PRESSES);
+#else
+    // 3. Button Configuration (GPIO Settings)
     gpio_config_t io_conf = {};
     io_conf.intr_type = GPIO_INTR_NEGEDGE; // Trigger on Falling Edge (Press)
     io_conf.pin_bit_mask = (1ULL << BOOT_BUTTON_PIN);
@@ -79,16 +311,13 @@ void app_main(void)
     io_conf.pull_up_en = 1;                // Enable internal pull-up
     gpio_config(&io_conf);
 
-    // 3. Create the Handler Task
-    // We give it high priority (10) to respond immediately.
-    xTaskCreate(button_handler_task, "Button_Task", 2048, NULL, 10, NULL);
-
     // 4. Install ISR Service and Add Handler
     // Must install the service before adding any specific handlers
     gpio_install_isr_service(0);
     
-    // Attach our 'gpio_isr_handler' function to the specific pin
-    gpio_isr_handler_add(BOOT_BUTTON_PIN, gpio_isr_handler, NULL);
+    // Attach the capture ISR to the specific pin, the capture is its argument
+    gpio_isr_handler_add(BOOT_BUTTON_PIN, edge_capture_isr_handler, &button_capture);
 
-    ESP_LOGI("System Ready! Waiting for BOOT button press...\n");
-}
\ No newline at end of file
+    ESP_LOGI(TAG, "System Ready! Waiting for BOOT button press...");
+#endif
+}
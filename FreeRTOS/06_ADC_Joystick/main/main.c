@@ -22,6 +22,8 @@
 #include "esp_log.h"
 #include "esp_adc/adc_oneshot.h" //ESP-IDF v5.x new ADC library
 #include "driver/gpio.h"
+#include "static_alloc.h"
+#include "alloc_stats.h"
 
 
 // --- CONFIGURATION ---
@@ -54,6 +56,10 @@
 #define DOWN_VALUE          1000
 #define QUEUE_LENGTH        50
 
+//.. Stack sizes are in bytes on ESP-IDF
+#define ADC_READER_STACK    2048
+#define CONTROLLER_STACK    2048
+
 // --- DEBUGGING ---
 static const char *TAG =    "JOYSTICK_APP";
 
@@ -66,6 +72,11 @@ typedef struct {
 } joystick_data_t;
 
 
+// --- KERNEL OBJECTS ---
+STATIC_TASK_DECLARE(adc_reader, ADC_READER_STACK);
+STATIC_TASK_DECLARE(controller, CONTROLLER_STACK);
+STATIC_QUEUE_DECLARE(joystick_queue, QUEUE_LENGTH, sizeof(joystick_data_t));
+
 //Global Queue Handle
 QueueHandle_t xJoystickQueue;
 
@@ -268,9 +279,10 @@ void controller_task(void *pvParameters)
 
 void app_main(void)
 {
+    alloc_stats_begin();
 
     //.. Create Queue
-    xJoystickQueue = xQueueCreate(QUEUE_LENGTH, sizeof(joystick_data_t));
+    xJoystickQueue = STATIC_QUEUE_CREATE(joystick_queue);
 
     if (NULL == xJoystickQueue) 
     {
@@ -279,16 +291,17 @@ void app_main(void)
     }
 
     //.. Create Tasks
-    BaseType_t adc_read = xTaskCreate(adc_reader_task, "ADC_Reader", 2048, NULL, 5, NULL);
-    if (pdFAIL == adc_read )
+    if (NULL == STATIC_TASK_CREATE(adc_reader, adc_reader_task, "ADC_Reader", NULL, 5))
     {
         ESP_LOGE(TAG, "ADC Reader Task creation failed!");
     }
-    BaseType_t controller = xTaskCreate(controller_task, "Controller", 2048, NULL, 5, NULL);
-    if (pdFAIL == controller)
+    if (NULL == STATIC_TASK_CREATE(controller, controller_task, "Controller", NULL, 5))
     {
         ESP_LOGE(TAG, "Controller Task creation failed!");
     }
 
     ESP_LOGI(TAG, "System Initializing...");
-}
+
+    //.. Boot & Heap Report, compare a static and a dynamic build (see README.md)
+    alloc_stats_report(TAG);
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include <stdio.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "alloc_stats.h"
+
+// --- CONFIGURATION ---
+#define CHURN_ROUNDS        32      // Create/delete cycles
+#define CHURN_OBJECTS       16      // Queues alive per cycle
+#define CHURN_ITEM_SIZE     16
+
+#if CONFIG_STATIC_ALLOC_ENABLE
+#define ALLOC_MODE          "static"
+#else
+#define ALLOC_MODE          "dynamic"
+#endif
+
+static int64_t s_begin_us;
+static size_t s_begin_free;
+
+
+//.. Fragmentation = how much of the free heap is NOT usable as one block
+static unsigned fragmentation_percent(void)
+{
+    size_t free_heap = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    size_t largest_block = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+    if (free_heap == 0)
+    {
+        return 0;
+    }
+    return (unsigned)(100 - (largest_block * 100) / free_heap);
+}
+
+void alloc_stats_begin(void)
+{
+    s_begin_us = esp_timer_get_time();
+    s_begin_free = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+}
+
+void alloc_stats_report(const char *tag)
+{
+    int64_t end_us = esp_timer_get_time();
+    size_t end_free = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    unsigned boot_frag = fragmentation_percent();
+
+    //.. Churn: create queues of different sizes, delete every second one, sample, delete the rest.
+    //.. The holes left behind show how the startup objects split the heap.
+    unsigned worst_frag = 0;
+    unsigned failed = 0;
+    for (int round = 0; round < CHURN_ROUNDS; round++)
+    {
+        QueueHandle_t queues[CHURN_OBJECTS];
+        for (int i = 0; i < CHURN_OBJECTS; i++)
+        {
+            queues[i] = xQueueCreate(1 + ((i * 7 + round) % 32), CHURN_ITEM_SIZE);
+            failed += (queues[i] == NULL);
+        }
+        for (int i = 0; i < CHURN_OBJECTS; i += 2)
+        {
+            if (queues[i] != NULL) vQueueDelete(queues[i]);
+        }
+
+        unsigned frag = fragmentation_percent();
+        if (frag > worst_frag) worst_frag = frag;
+
+        for (int i = 1; i < CHURN_OBJECTS; i += 2)
+        {
+            if (queues[i] != NULL) vQueueDelete(queues[i]);
+        }
+    }
+
+    ESP_LOGI(tag, "--- ALLOC STATS (" ALLOC_MODE ") ---");
+    ESP_LOGI(tag, "Boot time: %lld us | Startup (app_main): %lld us",
+             (long long)end_us, (long long)(end_us - s_begin_us));
+    ESP_LOGI(tag, "Heap used by startup: %d bytes | Free: %u | Min free: %u",
+             (int)(s_begin_free - end_free), (unsigned)end_free,
+             (unsigned)heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT));
+    ESP_LOGI(tag, "Fragmentation: after boot %u%% | worst during churn %u%% | after churn %u%% (%u failed)",
+             boot_frag, worst_frag, fragmentation_percent(), failed);
+}
@@ -0,0 +1,21 @@
+/**
+ * @file alloc_stats.h
+ * @brief Boot time and heap fragmentation report (ESP targets only)
+ *
+ * Call alloc_stats_begin() as the first line of app_main() and
+ * alloc_stats_report() after all kernel objects are created. Build the app
+ * with CONFIG_STATIC_ALLOC_ENABLE=n and =y and compare the printed lines.
+ * */
+
+#pragma once
+
+/**
+ * @brief Remember the time and free heap at the start of app_main().
+ */
+void alloc_stats_begin(void);
+
+/**
+ * @brief Print startup time, heap used by startup, and fragmentation after a
+ * fixed create/delete cycle of queues (same pattern in every run).
+ */
+void alloc_stats_report(const char *tag);
@@ -0,0 +1,114 @@
+/**
+ * @file static_alloc.h
+ * @brief Declaration layer for FreeRTOS kernel objects (static or dynamic)
+ *
+ * Every task, queue, semaphore, event group and timer of an example is
+ * declared at file scope with a STATIC_*_DECLARE() macro and created with the
+ * matching STATIC_*_CREATE() macro. CONFIG_STATIC_ALLOC_ENABLE selects the mode:
+ *
+ *   n (default) --> objects are allocated from the heap (xTaskCreate, xQueueCreate, ...)
+ *   y           --> objects live in .bss as kobj_<name>_* symbols, nothing is taken
+ *                   from the heap at startup and the RAM usage is fixed at link time
+ *
+ * The CREATE macros return the handle (NULL on failure) in both modes.
+ * static_alloc_budget_report() in project_include.cmake lists the kobj_* symbols
+ * after every build.
+ * */
+
+#pragma once
+
+#include <stdint.h>
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/event_groups.h"
+#include "freertos/timers.h"
+
+#if CONFIG_STATIC_ALLOC_ENABLE
+
+// --- TASKS ---
+//.. Stack size is in bytes, like xTaskCreate() on ESP-IDF
+#define STATIC_TASK_DECLARE(name, stack_size) \
+    static StackType_t kobj_##name##_stack[(stack_size) / sizeof(StackType_t)]; \
+    static StaticTask_t kobj_##name##_tcb
+#define STATIC_TASK_CREATE(name, fn, label, params, prio) \
+    xTaskCreateStatic((fn), (label), sizeof(kobj_##name##_stack), (params), (prio), \
+                      kobj_##name##_stack, &kobj_##name##_tcb)
+
+// --- QUEUES ---
+#define STATIC_QUEUE_DECLARE(name, length, item_size) \
+    enum { kobj_##name##_length = (length), kobj_##name##_item_size = (item_size) }; \
+    static uint8_t kobj_##name##_storage[(length) * (item_size)]; \
+    static StaticQueue_t kobj_##name##_queue
+#define STATIC_QUEUE_CREATE(name) \
+    xQueueCreateStatic(kobj_##name##_length, kobj_##name##_item_size, \
+                       kobj_##name##_storage, &kobj_##name##_queue)
+
+// --- SEMAPHORES & MUTEXES ---
+#define STATIC_SEMAPHORE_DECLARE(name) \
+    static StaticSemaphore_t kobj_##name##_sem
+#define STATIC_BINARY_SEMAPHORE_CREATE(name) \
+    xSemaphoreCreateBinaryStatic(&kobj_##name##_sem)
+#define STATIC_COUNTING_SEMAPHORE_CREATE(name, max_count, initial_count) \
+    xSemaphoreCreateCountingStatic((max_count), (initial_count), &kobj_##name##_sem)
+#define STATIC_MUTEX_CREATE(name) \
+    xSemaphoreCreateMutexStatic(&kobj_##name##_sem)
+
+// --- EVENT GROUPS ---
+#define STATIC_EVENT_GROUP_DECLARE(name) \
+    static StaticEventGroup_t kobj_##name##_group
+#define STATIC_EVENT_GROUP_CREATE(name) \
+    xEventGroupCreateStatic(&kobj_##name##_group)
+
+// --- SOFTWARE TIMERS ---
+#define STATIC_TIMER_DECLARE(name) \
+    static StaticTimer_t kobj_##name##_timer
+#define STATIC_TIMER_CREATE(name, label, period, auto_reload, id, callback) \
+    xTimerCreateStatic((label), (period), (auto_reload), (id), (callback), &kobj_##name##_timer)
+
+#else
+
+//.. Dynamic mode: the DECLARE macros only keep the sizes, nothing is reserved
+static inline TaskHandle_t static_alloc_task_create(TaskFunction_t fn, const char *label, uint32_t stack_size,
+                                                    void *params, UBaseType_t prio)
+{
+    TaskHandle_t handle = NULL;
+    if (xTaskCreate(fn, label, stack_size, params, prio, &handle) != pdPASS)
+    {
+        return NULL;
+    }
+    return handle;
+}
+
+#define STATIC_TASK_DECLARE(name, stack_size) \
+    enum { kobj_##name##_stack_size = (stack_size) }
+#define STATIC_TASK_CREATE(name, fn, label, params, prio) \
+    static_alloc_task_create((fn), (label), kobj_##name##_stack_size, (params), (prio))
+
+#define STATIC_QUEUE_DECLARE(name, length, item_size) \
+    enum { kobj_##name##_length = (length), kobj_##name##_item_size = (item_size) }
+#define STATIC_QUEUE_CREATE(name) \
+    xQueueCreate(kobj_##name##_length, kobj_##name##_item_size)
+
+#define STATIC_SEMAPHORE_DECLARE(name) \
+    enum { kobj_##name##_sem_declared = 1 }
+#define STATIC_BINARY_SEMAPHORE_CREATE(name) \
+    xSemaphoreCreateBinary()
+#define STATIC_COUNTING_SEMAPHORE_CREATE(name, max_count, initial_count) \
+    xSemaphoreCreateCounting((max_count), (initial_count))
+#define STATIC_MUTEX_CREATE(name) \
+    xSemaphoreCreateMutex()
+
+#define STATIC_EVENT_GROUP_DECLARE(name) \
+    enum { kobj_##name##_group_declared = 1 }
+#define STATIC_EVENT_GROUP_CREATE(name) \
+    xEventGroupCreate()
+
+#define STATIC_TIMER_DECLARE(name) \
+    enum { kobj_##name##_timer_declared = 1 }
+#define STATIC_TIMER_CREATE(name, label, period, auto_reload, id, callback) \
+    xTimerCreate((label), (period), (auto_reload), (id), (callback))
+
+#endif // CONFIG_STATIC_ALLOC_ENABLE
@@ -0,0 +1,23 @@
+# static_alloc_budget_report(<budget_bytes>)
+#
+# Call after project(). When CONFIG_STATIC_ALLOC_ENABLE is set, every build
+# lists the kobj_* symbols of the ELF (stacks, TCBs, queue storage, ...) in
+# build/static_alloc_report.txt and fails if their total exceeds the budget.
+function(static_alloc_budget_report budget_bytes)
+    if(NOT CONFIG_STATIC_ALLOC_ENABLE)
+        return()
+    endif()
+
+    idf_build_get_property(python PYTHON)
+    idf_component_get_property(component_dir static_alloc COMPONENT_DIR)
+    set(elf ${CMAKE_PROJECT_NAME}.elf)
+
+    add_custom_command(TARGET ${elf} POST_BUILD
+        COMMAND ${python} ${component_dir}/static_alloc_report.py
+                --nm ${CMAKE_NM}
+                --budget ${budget_bytes}
+                --output ${CMAKE_BINARY_DIR}/static_alloc_report.txt
+                $<TARGET_FILE:${elf}>
+        COMMENT "Generating static kernel object memory report"
+        VERBATIM)
+endfunction()
@@ -0,0 +1,67 @@
+#!/usr/bin/env python3
+"""
+Memory budget report for statically allocated kernel objects.
+
+Reads the kobj_<name>_<part> symbols created by static_alloc.h from the ELF
+and prints one line per object. Exits with an error if the total is larger
+than the budget, so the build fails.
+"""
+
+import argparse
+import re
+import subprocess
+import sys
+from collections import OrderedDict
+
+PARTS = ("stack", "tcb", "storage", "queue", "sem", "group", "timer")
+SYMBOL = re.compile(r"^[0-9a-fA-F]+\s+([0-9a-fA-F]+)\s+[bBdD]\s+kobj_(\w+)_(%s)$" % "|".join(PARTS))
+
+
+def collect(nm, elf):
+    output = subprocess.run([nm, "-S", elf], check=True, capture_output=True, text=True).stdout
+    objects = OrderedDict()
+    for line in output.splitlines():
+        match = SYMBOL.match(line.strip())
+        if not match:
+            continue
+        size, name, part = int(match.group(1), 16), match.group(2), match.group(3)
+        objects.setdefault(name, dict.fromkeys(PARTS, 0))[part] += size
+    return objects
+
+
+def render(objects, budget):
+    header = f"{'Object':<24}" + "".join(f"{p:>9}" for p in PARTS) + f"{'Total':>9}"
+    lines = [f"Static kernel objects (budget {budget} bytes)", header, "-" * len(header)]
+    total = 0
+    for name in sorted(objects, key=lambda n: -sum(objects[n].values())):
+        sizes = objects[name]
+        object_total = sum(sizes.values())
+        total += object_total
+        lines.append(f"{name:<24}" + "".join(f"{sizes[p]:>9}" for p in PARTS) + f"{object_total:>9}")
+    lines.append("-" * len(header))
+    percent = (total * 100) // budget if budget else 0
+    lines.append(f"{'TOTAL':<24}{total:>{9 * (len(PARTS) + 1)}} / {budget} ({percent}%)")
+    return "\n".join(lines), total
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("elf")
+    parser.add_argument("--nm", default="nm")
+    parser.add_argument("--budget", type=int, required=True)
+    parser.add_argument("--output")
+    args = parser.parse_args()
+
+    report, total = render(collect(args.nm, args.elf), args.budget)
+    print(report)
+    if args.output:
+        with open(args.output, "w") as out:
+            out.write(report + "\n")
+
+    if total > args.budget:
+        print(f"error: static kernel objects use {total} bytes, budget is {args.budget}", file=sys.stderr)
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
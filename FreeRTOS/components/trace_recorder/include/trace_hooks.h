@@ -0,0 +1,65 @@
+/**
+ * @file trace_hooks.h
+ * @brief FreeRTOS trace macro overrides for the trace recorder
+ *
+ * This header is force-included (-include) into every source file of the
+ * build, so the kernel sees these macros before its own empty defaults in
+ * FreeRTOS.h. Keep it free of FreeRTOS includes: only plain C types here.
+ * */
+
+#pragma once
+
+#ifndef __ASSEMBLER__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// --- EVENT TYPES (1 byte in the record) ---
+typedef enum {
+    TRACE_EVT_TASK_CREATE = 1,
+    TRACE_EVT_TASK_DELETE,
+    TRACE_EVT_TASK_SWITCHED_IN,
+    TRACE_EVT_TASK_DELAY,
+    TRACE_EVT_QUEUE_SEND,
+    TRACE_EVT_QUEUE_SEND_FAILED,
+    TRACE_EVT_QUEUE_SEND_FROM_ISR,
+    TRACE_EVT_QUEUE_RECEIVE,
+    TRACE_EVT_QUEUE_RECEIVE_FAILED,
+    TRACE_EVT_QUEUE_RECEIVE_FROM_ISR,
+    TRACE_EVT_QUEUE_BLOCK_SEND,
+    TRACE_EVT_QUEUE_BLOCK_RECEIVE,
+} trace_event_t;
+
+//.. Called by the kernel, the argument is a TCB or Queue_t pointer
+void trace_hook_task_create(void *tcb);
+void trace_hook_task_delete(void *tcb);
+void trace_hook_task_switched_in(void);
+void trace_hook_task_delay(void);
+void trace_hook_queue(uint8_t event, void *queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+// --- KERNEL MACROS ---
+//.. Semaphores and mutexes are queues inside the kernel, so give/take show up as send/receive
+#define traceTASK_CREATE(pxNewTCB)                trace_hook_task_create((void *)(pxNewTCB))
+#define traceTASK_DELETE(pxTCB)                   trace_hook_task_delete((void *)(pxTCB))
+#define traceTASK_SWITCHED_IN()                   trace_hook_task_switched_in()
+#define traceTASK_DELAY()                         trace_hook_task_delay()
+#define traceTASK_DELAY_UNTIL(xTimeToWake)        trace_hook_task_delay()
+
+#define traceQUEUE_SEND(pxQueue)                  trace_hook_queue(TRACE_EVT_QUEUE_SEND, (void *)(pxQueue))
+#define traceQUEUE_SEND_FAILED(pxQueue)           trace_hook_queue(TRACE_EVT_QUEUE_SEND_FAILED, (void *)(pxQueue))
+#define traceQUEUE_SEND_FROM_ISR(pxQueue)         trace_hook_queue(TRACE_EVT_QUEUE_SEND_FROM_ISR, (void *)(pxQueue))
+#define traceQUEUE_GIVE_FROM_ISR(pxQueue)         trace_hook_queue(TRACE_EVT_QUEUE_SEND_FROM_ISR, (void *)(pxQueue))
+#define traceQUEUE_RECEIVE(pxQueue)               trace_hook_queue(TRACE_EVT_QUEUE_RECEIVE, (void *)(pxQueue))
+#define traceQUEUE_RECEIVE_FAILED(pxQueue)        trace_hook_queue(TRACE_EVT_QUEUE_RECEIVE_FAILED, (void *)(pxQueue))
+#define traceQUEUE_RECEIVE_FROM_ISR(pxQueue)      trace_hook_queue(TRACE_EVT_QUEUE_RECEIVE_FROM_ISR, (void *)(pxQueue))
+#define traceBLOCKING_ON_QUEUE_SEND(pxQueue)      trace_hook_queue(TRACE_EVT_QUEUE_BLOCK_SEND, (void *)(pxQueue))
+#define traceBLOCKING_ON_QUEUE_RECEIVE(pxQueue)   trace_hook_queue(TRACE_EVT_QUEUE_BLOCK_RECEIVE, (void *)(pxQueue))
+
+#endif // __ASSEMBLER__
@@ -0,0 +1,419 @@
+/**
+ * @file trace_recorder.c
+ * @brief Low-overhead FreeRTOS kernel event recorder
+ *
+ * Writers (kernel hooks) reserve a slot with one atomic add, fill it and
+ * set its commit marker, there is no lock on the hot path. A low priority
+ * flush task prints the committed records as hex lines, so the dump
+ * survives idf.py monitor and stdout.
+ *
+ * Output lines:
+ *   TRACE:N,<id>,<name>    Task or queue name
+ *   TRACE:E,<hex>          Up to 4 raw trace_record_t, little endian
+ *   TRACE:L,<count>        Records lost (buffer overrun or full snapshot)
+ *
+ * Every line is written with a single printf(), so log output of other tasks
+ * can not land in the middle of it.
+ * */
+
+#include <stdio.h>
+#include <string.h>
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "esp_log.h"
+#include "static_alloc.h"
+#include "trace_recorder.h"
+
+#if CONFIG_IDF_TARGET_LINUX
+#include <time.h>
+#define TRACE_IRAM_ATTR
+#else
+#include "esp_attr.h"
+#include "esp_cpu.h"
+#include "esp_timer.h"
+//.. Context switches also happen while the flash cache is disabled
+#define TRACE_IRAM_ATTR     IRAM_ATTR
+#endif
+
+#if !configUSE_TRACE_FACILITY
+#error "trace_recorder needs CONFIG_FREERTOS_USE_TRACE_FACILITY=y"
+#endif
+
+// --- CONFIGURATION ---
+#define TRACE_BUFFER_RECORDS    CONFIG_TRACE_RECORDER_BUFFER_RECORDS
+#define TRACE_MAX_OBJECTS       CONFIG_TRACE_RECORDER_MAX_OBJECTS
+#define TRACE_FLUSH_PERIOD_MS   CONFIG_TRACE_RECORDER_FLUSH_PERIOD_MS
+#define TRACE_NAME_LEN          configMAX_TASK_NAME_LEN
+#define TRACE_RECORDS_PER_LINE  4
+#define TRACE_FLUSH_STACK       3072
+#define TRACE_PROBE_RECORDS     64      // Private buffer of trace_recorder_measure_overhead()
+#define TRACE_PROBE_ROUNDS      1024
+#define TRACE_PROBE_RUNS        8
+
+_Static_assert((TRACE_BUFFER_RECORDS & (TRACE_BUFFER_RECORDS - 1)) == 0,
+               "CONFIG_TRACE_RECORDER_BUFFER_RECORDS must be a power of two");
+_Static_assert(sizeof(trace_record_t) == 8, "trace_record_t must stay 8 bytes");
+
+static const char *TAG = "TRACE";
+
+// --- STATE ---
+static trace_record_t s_buffer[TRACE_BUFFER_RECORDS];
+static uint16_t s_commit[TRACE_BUFFER_RECORDS];     // Lap + 1 of the record in the slot, written last
+static uint32_t s_head;                     // Records reserved so far (atomic)
+static uint32_t s_tail;                     // Records printed so far (flush only)
+static volatile trace_mode_t s_mode = TRACE_MODE_OFF;
+static trace_mode_t s_buffer_mode = TRACE_MODE_OFF;
+
+//.. Id 0 means "unknown", e.g. a queue that was never named.
+//.. A name is printed only after its ready flag is set, never half written.
+static uint32_t s_next_id = 1;
+static uint32_t s_names_sent = 1;
+static char s_names[TRACE_MAX_OBJECTS][TRACE_NAME_LEN];
+static uint8_t s_name_ready[TRACE_MAX_OBJECTS];
+
+//.. The flush task is created once and parks between recordings, so a
+//.. static TCB is never reused while the old task still exists
+static TaskHandle_t s_flush_task = NULL;
+static volatile bool s_flushing = false;
+STATIC_TASK_DECLARE(trace_flush, TRACE_FLUSH_STACK);
+
+
+static inline TRACE_IRAM_ATTR uint32_t trace_time_us(void)
+{
+#if CONFIG_IDF_TARGET_LINUX
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL);
+#else
+    return (uint32_t)esp_timer_get_time();
+#endif
+}
+
+static inline TRACE_IRAM_ATTR uint8_t trace_core_id(void)
+{
+#if CONFIG_IDF_TARGET_LINUX
+    return 0;
+#else
+    return (uint8_t)esp_cpu_get_core_id();
+#endif
+}
+
+static inline TRACE_IRAM_ATTR void trace_store(trace_record_t *rec, uint8_t event, uint16_t object_id)
+{
+    rec->timestamp_us = trace_time_us();
+    rec->event = event;
+    rec->core_id = trace_core_id();
+    rec->object_id = object_id;
+}
+
+//.. Marker of a finished record: slot N and slot N + TRACE_BUFFER_RECORDS differ
+static inline TRACE_IRAM_ATTR uint16_t trace_lap(uint32_t slot)
+{
+    return (uint16_t)(slot / TRACE_BUFFER_RECORDS + 1);
+}
+
+static inline TRACE_IRAM_ATTR void trace_record(uint8_t event, uint16_t object_id)
+{
+    uint32_t slot = __atomic_fetch_add(&s_head, 1, __ATOMIC_RELAXED);
+
+    //.. Snapshot keeps the first N records, the rest is counted as lost
+    if (s_buffer_mode == TRACE_MODE_SNAPSHOT && slot >= TRACE_BUFFER_RECORDS)
+    {
+        return;
+    }
+
+    uint32_t index = slot & (TRACE_BUFFER_RECORDS - 1);
+    trace_store(&s_buffer[index], event, object_id);
+
+    //.. Commit last: the flush task reads the slot only after it sees this marker
+    __atomic_store_n(&s_commit[index], trace_lap(slot), __ATOMIC_RELEASE);
+}
+
+static uint16_t trace_register_name(const char *name)
+{
+    uint32_t id = __atomic_fetch_add(&s_next_id, 1, __ATOMIC_RELAXED);
+    if (id < TRACE_MAX_OBJECTS)
+    {
+        if (name != NULL)
+        {
+            strncpy(s_names[id], name, TRACE_NAME_LEN - 1);
+        }
+        //.. Publish only now, the flush task may already be waiting for this id
+        __atomic_store_n(&s_name_ready[id], 1, __ATOMIC_RELEASE);
+    }
+    return (uint16_t)id;
+}
+
+
+// -------------------------------------------------------------------------
+// Kernel Hooks (see trace_hooks.h)
+// -------------------------------------------------------------------------
+void trace_hook_task_create(void *tcb)
+{
+    //.. Names are registered even before start, so idle/timer tasks are known
+    uint16_t id = trace_register_name(pcTaskGetName((TaskHandle_t)tcb));
+    vTaskSetTaskNumber((TaskHandle_t)tcb, id);
+
+    if (s_mode != TRACE_MODE_OFF)
+    {
+        trace_record(TRACE_EVT_TASK_CREATE, id);
+    }
+}
+
+void trace_hook_task_delete(void *tcb)
+{
+    if (s_mode != TRACE_MODE_OFF)
+    {
+        trace_record(TRACE_EVT_TASK_DELETE, (uint16_t)uxTaskGetTaskNumber((TaskHandle_t)tcb));
+    }
+}
+
+void TRACE_IRAM_ATTR trace_hook_task_switched_in(void)
+{
+    if (s_mode != TRACE_MODE_OFF)
+    {
+        trace_record(TRACE_EVT_TASK_SWITCHED_IN, (uint16_t)uxTaskGetTaskNumber(xTaskGetCurrentTaskHandle()));
+    }
+}
+
+void TRACE_IRAM_ATTR trace_hook_task_delay(void)
+{
+    if (s_mode != TRACE_MODE_OFF)
+    {
+        trace_record(TRACE_EVT_TASK_DELAY, (uint16_t)uxTaskGetTaskNumber(xTaskGetCurrentTaskHandle()));
+    }
+}
+
+void TRACE_IRAM_ATTR trace_hook_queue(uint8_t event, void *queue)
+{
+    if (s_mode == TRACE_MODE_OFF)
+    {
+        return;
+    }
+
+    //.. printf() of the flush task takes locks too, don't let it trace itself
+    if (s_flush_task != NULL && xTaskGetCurrentTaskHandle() == s_flush_task)
+    {
+        return;
+    }
+
+    trace_record(event, (uint16_t)uxQueueGetQueueNumber((QueueHandle_t)queue));
+}
+
+
+// -------------------------------------------------------------------------
+// Output
+// -------------------------------------------------------------------------
+void trace_recorder_flush(void)
+{
+    //.. New names first, so the host can resolve every id in the records below
+    uint32_t name_count = __atomic_load_n(&s_next_id, __ATOMIC_ACQUIRE);
+    if (name_count > TRACE_MAX_OBJECTS)
+    {
+        name_count = TRACE_MAX_OBJECTS;
+    }
+    //.. Stop at the first name that is still being written, it is sent next time
+    for (; s_names_sent < name_count; s_names_sent++)
+    {
+        if (!__atomic_load_n(&s_name_ready[s_names_sent], __ATOMIC_ACQUIRE))
+        {
+            break;
+        }
+        printf("TRACE:N,%lu,%s\n", (unsigned long)s_names_sent, s_names[s_names_sent]);
+    }
+
+    uint32_t head = __atomic_load_n(&s_head, __ATOMIC_ACQUIRE);
+    uint32_t lost = 0;
+
+    if (s_buffer_mode == TRACE_MODE_SNAPSHOT && head > TRACE_BUFFER_RECORDS)
+    {
+        lost = head - TRACE_BUFFER_RECORDS;
+        head = TRACE_BUFFER_RECORDS;
+    }
+    else if (head - s_tail > TRACE_BUFFER_RECORDS)
+    {
+        //.. Stream overrun: writers were faster than the flush period
+        lost = head - s_tail - TRACE_BUFFER_RECORDS;
+        s_tail = head - TRACE_BUFFER_RECORDS;
+    }
+
+    while (s_tail < head)
+    {
+        uint32_t count = head - s_tail;
+        if (count > TRACE_RECORDS_PER_LINE)
+        {
+            count = TRACE_RECORDS_PER_LINE;
+        }
+
+        //.. Stop at the first slot that is reserved but not written yet (the
+        //.. writer was interrupted or runs on the other core), it is sent next time
+        trace_record_t line[TRACE_RECORDS_PER_LINE];
+        uint32_t ready = 0;
+        while (ready < count)
+        {
+            uint32_t slot = s_tail + ready;
+            uint32_t index = slot & (TRACE_BUFFER_RECORDS - 1);
+            if (__atomic_load_n(&s_commit[index], __ATOMIC_ACQUIRE) != trace_lap(slot))
+            {
+                break;
+            }
+            line[ready++] = s_buffer[index];
+        }
+        if (ready == 0)
+        {
+            break;
+        }
+        count = ready;
+
+        //.. The writers may have wrapped over the slots while we were copying
+        if (s_buffer_mode == TRACE_MODE_STREAM &&
+            __atomic_load_n(&s_head, __ATOMIC_ACQUIRE) - s_tail > TRACE_BUFFER_RECORDS)
+        {
+            lost += count;
+            s_tail += count;
+            continue;
+        }
+
+        //.. Build the whole line first, then print it at once
+        static const char hex[] = "0123456789abcdef";
+        char text[sizeof("TRACE:E,") + 2 * sizeof(line) + 1] = "TRACE:E,";
+        char *out = text + sizeof("TRACE:E,") - 1;
+        const uint8_t *bytes = (const uint8_t *)line;
+        for (uint32_t i = 0; i < count * sizeof(trace_record_t); i++)
+        {
+            *out++ = hex[bytes[i] >> 4];
+            *out++ = hex[bytes[i] & 0x0F];
+        }
+        *out++ = '\n';
+        *out = '\0';
+        printf("%s", text);
+        s_tail += count;
+    }
+
+    if (lost > 0)
+    {
+        printf("TRACE:L,%lu\n", (unsigned long)lost);
+    }
+    fflush(stdout);
+}
+
+static void trace_flush_task(void *pvParameters)
+{
+    while (1)
+    {
+        if (s_buffer_mode == TRACE_MODE_SNAPSHOT)
+        {
+            //.. Wait until the buffer is full (or someone stops the recorder)
+            while (s_mode == TRACE_MODE_SNAPSHOT &&
+                   __atomic_load_n(&s_head, __ATOMIC_ACQUIRE) < TRACE_BUFFER_RECORDS)
+            {
+                vTaskDelay(pdMS_TO_TICKS(TRACE_FLUSH_PERIOD_MS));
+            }
+            trace_recorder_stop();
+        }
+        else
+        {
+            while (s_mode == TRACE_MODE_STREAM)
+            {
+                vTaskDelay(pdMS_TO_TICKS(TRACE_FLUSH_PERIOD_MS));
+                trace_recorder_flush();
+            }
+        }
+
+        //.. Give writers that passed the mode check before the stop time to commit
+        vTaskDelay(1);
+        trace_recorder_flush();
+        ESP_LOGI(TAG, "Trace dump finished");
+
+        //.. Park until the next trace_recorder_start()
+        s_flushing = false;
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+}
+
+
+// -------------------------------------------------------------------------
+// Public API
+// -------------------------------------------------------------------------
+void trace_recorder_start(trace_mode_t mode)
+{
+    if (mode == TRACE_MODE_OFF || s_mode != TRACE_MODE_OFF || s_flushing)
+    {
+        return;
+    }
+
+    //.. Every recording starts with an empty buffer (the writers are off here)
+    memset(s_commit, 0, sizeof(s_commit));
+    __atomic_store_n(&s_head, 0, __ATOMIC_RELEASE);
+    s_tail = 0;
+
+    s_buffer_mode = mode;
+    s_mode = mode;
+    s_flushing = true;
+
+    if (s_flush_task != NULL)
+    {
+        xTaskNotifyGive(s_flush_task);
+    }
+    else
+    {
+        s_flush_task = STATIC_TASK_CREATE(trace_flush, trace_flush_task, "Trace_Flush", NULL, 1);
+        if (s_flush_task == NULL)
+        {
+            ESP_LOGE(TAG, "Flush task creation failed!");
+            s_mode = TRACE_MODE_OFF;
+            s_flushing = false;
+            return;
+        }
+    }
+
+    ESP_LOGI(TAG, "Recording started (%s, %d records)",
+             mode == TRACE_MODE_SNAPSHOT ? "snapshot" : "stream", TRACE_BUFFER_RECORDS);
+}
+
+void trace_recorder_stop(void)
+{
+    s_mode = TRACE_MODE_OFF;
+}
+
+void trace_recorder_name_queue(QueueHandle_t queue, const char *name)
+{
+    vQueueSetQueueNumber(queue, trace_register_name(name));
+}
+
+uint32_t trace_recorder_measure_overhead(void)
+{
+    //.. Same work as the context switch hook, but into a private buffer:
+    //.. the real hooks keep their own mode and never write into the probe.
+    static trace_record_t probe[TRACE_PROBE_RECORDS];
+    uint32_t probe_head = 0;
+    uint32_t best_us = UINT32_MAX;
+
+    //.. Best of several runs, so a tick interrupt in one run does not count
+    for (int run = 0; run < TRACE_PROBE_RUNS; run++)
+    {
+        uint32_t start = trace_time_us();
+        for (uint32_t i = 0; i < TRACE_PROBE_ROUNDS; i++)
+        {
+            uint32_t slot = __atomic_fetch_add(&probe_head, 1, __ATOMIC_RELAXED);
+            trace_store(&probe[slot & (TRACE_PROBE_RECORDS - 1)], TRACE_EVT_TASK_SWITCHED_IN,
+                        (uint16_t)uxTaskGetTaskNumber(xTaskGetCurrentTaskHandle()));
+        }
+        uint32_t elapsed = trace_time_us() - start;
+
+        //.. The probe is never read: keep the compiler from dropping the stores
+        __asm__ volatile("" : : "r"(probe) : "memory");
+
+        if (elapsed < best_us)
+        {
+            best_us = elapsed;
+        }
+    }
+
+    uint32_t ns_per_event = (uint32_t)(((uint64_t)best_us * 1000ULL) / TRACE_PROBE_ROUNDS);
+    ESP_LOGI(TAG, "Overhead: %lu ns per event (best of %d runs, %d events each)",
+             (unsigned long)ns_per_event, TRACE_PROBE_RUNS, TRACE_PROBE_ROUNDS);
+    return ns_per_event;
+}
@@ -0,0 +1,168 @@
+#!/usr/bin/env python3
+"""
+Convert a trace_recorder dump to Chrome-trace JSON (open in ui.perfetto.dev
+or chrome://tracing).
+
+The input is any log that contains the "TRACE:" lines, e.g. a saved
+idf.py monitor session or the stdout of a linux target build:
+
+    ./build/app.elf | tee trace.log
+    python3 tools/trace_to_perfetto.py trace.log -o trace.json
+"""
+
+import argparse
+import json
+import re
+import struct
+import sys
+
+# Must match trace_event_t in trace_hooks.h
+EVENTS = {
+    1: "TASK_CREATE",
+    2: "TASK_DELETE",
+    3: "TASK_SWITCHED_IN",
+    4: "TASK_DELAY",
+    5: "QUEUE_SEND",
+    6: "QUEUE_SEND_FAILED",
+    7: "QUEUE_SEND_FROM_ISR",
+    8: "QUEUE_RECEIVE",
+    9: "QUEUE_RECEIVE_FAILED",
+    10: "QUEUE_RECEIVE_FROM_ISR",
+    11: "QUEUE_BLOCK_SEND",
+    12: "QUEUE_BLOCK_RECEIVE",
+}
+TASK_SWITCHED_IN = 3
+FIRST_QUEUE_EVENT = 5
+
+RECORD = struct.Struct("<IBBH")  # trace_record_t
+LINE = re.compile(r"TRACE:([NEL]),(.*)$")
+
+HEX = re.compile(r"^[0-9a-fA-F]+$")
+
+PID = 1
+ISR_TID_BASE = 0x10000  # One "ISR core N" track per core, above all task ids
+
+
+def parse(lines):
+    names = {}
+    records = []
+    lost = 0
+    malformed = 0
+
+    for line in lines:
+        match = LINE.search(line.rstrip())
+        if not match:
+            continue
+        kind, payload = match.groups()
+
+        # A line broken by other log output is skipped, not fatal
+        if kind == "N":
+            obj_id, _, name = payload.partition(",")
+            if not obj_id.isdigit():
+                malformed += 1
+                continue
+            names[int(obj_id)] = name
+        elif kind == "L":
+            if not payload.strip().isdigit():
+                malformed += 1
+                continue
+            lost += int(payload)
+        else:
+            payload = payload.strip()
+            if not HEX.match(payload) or len(payload) % (2 * RECORD.size) != 0:
+                malformed += 1
+                continue
+            data = bytes.fromhex(payload)
+            for offset in range(0, len(data), RECORD.size):
+                records.append(RECORD.unpack_from(data, offset))
+
+    return names, records, lost, malformed
+
+
+def running_slice(core, task, start, end):
+    return {"ph": "X", "pid": PID, "tid": task, "name": "Running",
+            "ts": start, "dur": max(end - start, 0), "args": {"core": core}}
+
+
+def convert(names, records):
+    def name_of(obj_id):
+        return names.get(obj_id, f"id_{obj_id}")
+
+    events = [
+        {"ph": "M", "pid": PID, "name": "process_name", "args": {"name": "FreeRTOS"}},
+    ]
+    seen_tasks = set()
+    seen_cores = set()
+
+    # Timestamps are 32-bit microseconds, unwrap them into a monotonic clock
+    wrap = 0
+    last_raw = None
+    running = {}  # core id -> (task id, start time)
+    ts = 0
+
+    for raw_ts, event, core, obj_id in records:
+        if last_raw is not None and raw_ts < last_raw and last_raw - raw_ts > 0x80000000:
+            wrap += 1 << 32
+        last_raw = raw_ts
+        ts = raw_ts + wrap
+        seen_cores.add(core)
+        isr_tid = ISR_TID_BASE + core
+
+        # Each core runs its own task, a switch only ends the slice on the same core
+        if event == TASK_SWITCHED_IN:
+            if core in running:
+                events.append(running_slice(core, *running[core], ts))
+            running[core] = (obj_id, ts)
+            seen_tasks.add(obj_id)
+            continue
+
+        label = EVENTS.get(event, f"EVENT_{event}")
+        if event >= FIRST_QUEUE_EVENT:
+            if label.endswith("FROM_ISR") or core not in running:
+                tid = isr_tid
+            else:
+                tid = running[core][0]
+            args = {"queue": name_of(obj_id), "core": core}
+        else:
+            tid = obj_id
+            seen_tasks.add(obj_id)
+            args = {"task": name_of(obj_id)}
+
+        events.append({"ph": "i", "s": "t", "pid": PID, "tid": tid, "name": label,
+                       "ts": ts, "args": args})
+
+    # The tasks still running at the end of the dump run until its last record
+    for core, (task, start) in sorted(running.items()):
+        events.append(running_slice(core, task, start, ts))
+
+    for core in sorted(seen_cores):
+        events.append({"ph": "M", "pid": PID, "tid": ISR_TID_BASE + core, "name": "thread_name",
+                       "args": {"name": f"ISR core {core}"}})
+    for task in sorted(seen_tasks):
+        events.append({"ph": "M", "pid": PID, "tid": task, "name": "thread_name",
+                       "args": {"name": name_of(task)}})
+
+    return events
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input", nargs="?", default="-", help="log file with TRACE: lines (default: stdin)")
+    parser.add_argument("-o", "--output", default="trace.json", help="output JSON file")
+    args = parser.parse_args()
+
+    if args.input == "-":
+        names, records, lost, malformed = parse(sys.stdin)
+    else:
+        with open(args.input, errors="replace") as log:
+            names, records, lost, malformed = parse(log)
+
+    with open(args.output, "w") as out:
+        json.dump({"traceEvents": convert(names, records), "displayTimeUnit": "ms"}, out)
+
+    print(f"{len(records)} records, {len(names)} names, {lost} lost, "
+          f"{malformed} malformed lines skipped -> {args.output}")
+
+
+if __name__ == "__main__":
+    main()